@@ -1,307 +1,94 @@
+#include <algorithm>
 #include <chrono>
 #include <fstream>
 #include <iostream>
-#include <random>
+#include <span>
+#include <string>
 #include <vector>
-class ArrayGenerator {
-public:
-  static std::vector<int> genRandom(int n) {
-    std::mt19937 gen(12345);
-    std::uniform_int_distribution<> dist(0, 10000);
-    std::vector<int> generated(n);
-    for (int i = 0; i < n; i++) {
-      generated[i] = dist(gen);
-    }
-    return generated;
-  }
-
-  static std::vector<int> genSorted(int n) {
-    std::vector<int> generated(n);
-    for (int i = 0; i < n; i++) {
-      generated[i] = i;
-    }
-    return generated;
-  }
-  static std::vector<int> genReverseSorted(int n) {
-    std::vector<int> generated(n);
-    for (int i = 0; i < n; i++) {
-      generated[i] = n - i - 1;
-    }
-    return generated;
-  }
-
-  static std::vector<int> genNearlySorted(int n) {
-    std::vector<int> generated = genSorted(n);
-    std::mt19937 gen(12345);
-    std::uniform_int_distribution<int> dist(0, n - 2);
-
-    int swaps = n / 25;
-    for (int i = 0; i < swaps; i++) {
-      int pos = dist(gen);
-      std::swap(generated[pos], generated[pos + 1]);
-    }
-    return generated;
-  }
-
-  static std::vector<int> getSubArray(const std::vector<int> &baseArray, int exactSize) {
-    std::vector<int> result(baseArray.begin(), baseArray.begin() + exactSize);
-    return result;
-  }
-};
-
-void insertionSort(std::vector<int> &arr, const int left, const int right) {
-  for (int i = left + 1; i <= right; i++) {
-    int key = arr[i];
-    int j = i - 1;
-    while (j >= left && arr[j] > key) {
-      arr[j + 1] = arr[j];
-      j--;
-    }
-    arr[j + 1] = key;
-  }
-}
-
-void merge(std::vector<int> &arr, const int left, const int mid, const int right) {
-  std::vector<int> temp(right - left + 1);
-  int i = left;
-  int j = mid + 1;
-  int k = 0;
-  while (i <= mid && j <= right) {
-    if (arr[i] <= arr[j]) {
-      temp[k++] = arr[i++];
-    } else {
-      temp[k++] = arr[j++];
-    }
-  }
-  while (i <= mid) {
-    temp[k++] = arr[i++];
-  }
-  while (j <= right) {
-    temp[k++] = arr[j++];
-  }
-  for (int l = 0; l < static_cast<int>(temp.size()); l++) {
-    arr[left + l] = temp[l];
-  }
-}
-
-class MergeSort {
-private:
-  void mergeSort(std::vector<int> &arr, int left, int right) {
-    if (left >= right) {
-      return;
-    }
-    int mid = left + (right - left) / 2;
-    mergeSort(arr, left, mid);
-    mergeSort(arr, mid + 1, right);
-    merge(arr, left, mid, right);
-  }
-
-public:
-  void sort(std::vector<int> &arr) {
-    if (arr.empty()) {
-      return;
-    }
-    mergeSort(arr, 0, static_cast<int>(arr.size()) - 1);
-  }
-};
-
-class MergeInsertionSort {
-private:
-  int threshold;
-  void mergeInsertionSort(std::vector<int> &arr, int left, int right) {
-    if (right - left + 1 <= threshold) {
-      insertionSort(arr, left, right);
-      return;
-    }
-    int mid = left + (right - left) / 2;
-    mergeInsertionSort(arr, left, mid);
-    mergeInsertionSort(arr, mid + 1, right);
-    merge(arr, left, mid, right);
-  }
-
-public:
-  explicit MergeInsertionSort(int th) : threshold(th) {}
-  void MISort(std::vector<int> &arr) {
-    if (arr.empty()) {
-      return;
-    }
-    mergeInsertionSort(arr, 0, static_cast<int>(arr.size()) - 1);
-  }
-};
+#include "../common/ArrayGenerator.h"
+#include "../common/BenchArgs.h"
+#include "../common/BenchCsv.h"
+#include "../common/MergeSort.h"
+#include "../common/WorkArena.h"
 
 class SortTester {
 public:
-  static long long measureTimeMISort(std::vector<int>& arr, MergeInsertionSort &sorter) {
+  static long long measureTimeMISort(std::span<int> arr, std::span<int> temp, MergeInsertionSort &sorter) {
     using clock = std::chrono::steady_clock;
     auto start = clock::now();
-    sorter.MISort(arr);
+    sorter.MISort(arr, temp);
     auto elapsed = clock::now() - start;
     long long ms = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
     return ms;
   }
-  static long long measureTimeMergeSort(std::vector<int>& arr, MergeSort &sorter) {
+  static long long measureTimeMergeSort(std::span<int> arr, std::span<int> temp, MergeSort &sorter) {
     using clock = std::chrono::steady_clock;
     auto start = clock::now();
-    sorter.sort(arr);
+    sorter.sort(arr, temp);
     auto elapsed = clock::now() - start;
     long long ms = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
     return ms;
   }
 };
 
-int main() {
-  std::vector<int> sizes;
-  for (int i = 500; i <= 100000; i += 100) {
-    sizes.push_back(i);
+// argv[1] - максимальный размер массива (по умолчанию 100000), argv[2] - шаг (по умолчанию 100)
+int main(int argc, char **argv) {
+  std::size_t maxSize;
+  std::vector<std::size_t> sizes;
+  if (!parseBenchSizes(argc, argv, maxSize, sizes)) {
+    std::cerr << "usage: " << argv[0] << " " << kBenchUsage << "\n";
+    return 1;
   }
-  // --- Экспериментальные замеры для обычного MergeSort ---
-  // тест 1 (случайные массивы)
-  std::vector<int> base = ArrayGenerator::genRandom(100000);
-  std::ofstream outRandom("merge_sort_random.csv");
-  outRandom << "size;time_run1_ms;time_run2_ms;time_run3_ms;time_run4_ms;time_run5_ms;time_run6_ms;time_run7_ms;time_run8_ms;time_run9_ms;med_ms\n";
-  for (int size: sizes) {
-    std::vector<long long> times;
-    times.reserve(9);
-    std::vector<int> base_copy = ArrayGenerator::getSubArray(base, size);
-    for (int i = 0; i < 9; i++) {
-      MergeSort sorter;
-      std::vector<int> work_mas = base_copy;
-      long long ms = SortTester::measureTimeMergeSort(work_mas, sorter);
-      times.push_back(ms);
-    }
-    outRandom << size << ";" << times[0] << ";" << times[1] << ";" << times[2] << ";" << times[3] << ";"
-    << times[4] << ";" << times[5] << ";" << times[6] << ";" << times[7] << ";" << times[8] << ";";
-    std::sort(times.begin(), times.end());
-    long long med = times[4];
-    outRandom << med << "\n";
-  }
-  outRandom.close();
-  std::cout<<"MergeSort random done!\n";
-
-  // тест 2 (отсортированные в обратном порядке массивы)
-  std::vector<int> base2 = ArrayGenerator::genReverseSorted(100000);
-  std::ofstream outReverseSorted("merge_sort_reversed.csv");
-  outReverseSorted << "size;time_run1_ms;time_run2_ms;time_run3_ms;time_run4_ms;time_run5_ms;time_run6_ms;time_run7_ms;time_run8_ms;time_run9_ms;med_ms\n";
-  for (int size: sizes) {
-    std::vector<long long> times;
-    times.reserve(9);
-    std::vector<int> base2_copy = ArrayGenerator::getSubArray(base2, size);
-    for (int i = 0; i < 9; i++) {
-      MergeSort sorter;
-      std::vector<int> work_mas = base2_copy;
-      long long ms = SortTester::measureTimeMergeSort(work_mas, sorter);
-      times.push_back(ms);
-    }
-    outReverseSorted << size << ";" << times[0] << ";" << times[1] << ";" << times[2] << ";" << times[3] << ";"
-    << times[4] << ";" << times[5] << ";" << times[6] << ";" << times[7] << ";" << times[8] << ";";
-    std::sort(times.begin(), times.end());
-    long long med = times[4];
-    outReverseSorted << med << "\n";
-  }
-  outReverseSorted.close();
-  std::cout<<"MergeSort reverse done!\n";
-
-  // тест 3 ("почти" отсортированные массивы)
-  std::vector<int> base3 = ArrayGenerator::genNearlySorted(100000);
-  std::ofstream outNearlySorted("merge_sort_nearly_sorted.csv");
-  outNearlySorted << "size;time_run1_ms;time_run2_ms;time_run3_ms;time_run4_ms;time_run5_ms;time_run6_ms;time_run7_ms;time_run8_ms;time_run9_ms;med_ms\n";
-  for (int size: sizes) {
-    std::vector<long long> times;
-    times.reserve(9);
-    std::vector<int> base3_copy = ArrayGenerator::getSubArray(base3, size);
-    for (int i = 0; i < 9; i++) {
-      MergeSort sorter;
-      std::vector<int> work_mas = base3_copy;
-      long long ms = SortTester::measureTimeMergeSort(work_mas, sorter);
-      times.push_back(ms);
-    }
-    outNearlySorted << size << ";" << times[0] << ";" << times[1] << ";" << times[2] << ";" << times[3] << ";"
-    << times[4] << ";" << times[5] << ";" << times[6] << ";" << times[7] << ";" << times[8] << ";";
-    std::sort(times.begin(), times.end());
-    long long med = times[4];
-    outNearlySorted << med << "\n";
-  }
-  outNearlySorted.close();
-  std::cout<<"MergeSort nearly sorted done!\n";
-
-
-  // --- Экспериментальные замеры для MergeInsertionSort ---
   std::vector thresholds = {5, 10, 20, 30, 50};
-
-  // тест 1 (случайные массивы)
-  std::vector<int> base4 = ArrayGenerator::genRandom(100000);
-  std::ofstream outRandomMI("merge_insertion_sort_random.csv");
-  outRandomMI << "size;threshold;time_run1_ms;time_run2_ms;time_run3_ms;time_run4_ms;time_run5_ms;time_run6_ms;time_run7_ms;time_run8_ms;time_run9_ms;med_ms\n";
-  for (int size: sizes) {
-    for (int threshold: thresholds) {
+  // один рабочий буфер на все замеры: без выделений и page fault'ов внутри цикла
+  WorkArena arena(maxSize);
+  // буфер слияния тоже выделяется и прогревается один раз, а не в каждом merge
+  WorkArena mergeArena(maxSize);
+  std::span<int> mergeTemp = mergeArena.buffer();
+
+  for (const ArrayPattern &pattern: kArrayPatterns) {
+    std::vector<int> base = pattern.generate(maxSize);
+
+    // --- Экспериментальные замеры для обычного MergeSort ---
+    std::ofstream out(std::string("merge_sort_") + pattern.fileSuffix + ".csv");
+    out << "size;" << kTimesColumns << "\n";
+    for (std::size_t size: sizes) {
       std::vector<long long> times;
       times.reserve(9);
-      std::vector<int> base4_copy = ArrayGenerator::getSubArray(base4, size);
+      std::span<const int> view = ArrayGenerator::getSubArray(base, size);
       for (int i = 0; i < 9; i++) {
-        MergeInsertionSort sorter(threshold);
-        std::vector<int> work_mas = base4_copy;
-        long long ms = SortTester::measureTimeMISort(work_mas, sorter);
+        MergeSort sorter;
+        std::span<int> work_mas = arena.load(view);
+        long long ms = SortTester::measureTimeMergeSort(work_mas, mergeTemp, sorter);
         times.push_back(ms);
       }
-      outRandomMI << size << ";" << threshold <<";"<< times[0] << ";" << times[1] << ";" << times[2] << ";" << times[3]
-      << ";" << times[4] << ";" << times[5] << ";" << times[6] << ";" << times[7] << ";" << times[8] << ";";
-      std::sort(times.begin(), times.end());
-      long long med = times[4];
-      outRandomMI  << med << "\n";
-    }
-  }
-  outRandomMI.close();
-  std::cout<<"MergeInsertionSort random done!\n";
-
-  // тест 2 (отсортированные в обратном порядке массивы)
-  std::vector<int> base5 = ArrayGenerator::genReverseSorted(100000);
-  std::ofstream outReverseSortedMI("merge_insertion_sort_reversed.csv");
-  outReverseSortedMI << "size;threshold;time_run1_ms;time_run2_ms;time_run3_ms;time_run4_ms;time_run5_ms;time_run6_ms;time_run7_ms;time_run8_ms;time_run9_ms;med_ms\n";
-  for (int size: sizes) {
-    for (int threshold: thresholds) {
-      std::vector<long long> times;
-      times.reserve(9);
-      std::vector<int> base5_copy = ArrayGenerator::getSubArray(base5, size);
-      for (int i = 0; i < 9; i++) {
-        MergeInsertionSort sorter(threshold);
-        std::vector<int> work_mas = base5_copy;
-        long long ms = SortTester::measureTimeMISort(work_mas, sorter);
-        times.push_back(ms);
-      }
-      outReverseSortedMI << size << ";" << threshold <<";"<< times[0] << ";" << times[1] << ";" << times[2] << ";" << times[3]
-      << ";" << times[4] << ";" << times[5] << ";" << times[6] << ";" << times[7] << ";" << times[8] << ";";
-      std::sort(times.begin(), times.end());
-      long long med = times[4];
-      outReverseSortedMI  << med << "\n";
-    }
-  }
-  outReverseSortedMI.close();
-  std::cout<<"MergeInsertionSort reverse done!\n";
-
-  // тест 3 ("почти" отсортированные массивы)
-  std::vector<int> base6 = ArrayGenerator::genNearlySorted(100000);
-  std::ofstream outNearlySortedMI("merge_insertion_sort_nearly_sorted.csv");
-  outNearlySortedMI << "size;threshold;time_run1_ms;time_run2_ms;time_run3_ms;time_run4_ms;time_run5_ms;time_run6_ms;time_run7_ms;time_run8_ms;time_run9_ms;med_ms\n";
-  for (int size: sizes) {
-    for (int threshold: thresholds) {
-      std::vector<long long> times;
-      times.reserve(9);
-      std::vector<int> base6_copy = ArrayGenerator::getSubArray(base6, size);
-      for (int i = 0; i < 9; i++) {
-        MergeInsertionSort sorter(threshold);
-        std::vector<int> work_mas = base6_copy;
-        long long ms = SortTester::measureTimeMISort(work_mas, sorter);
-        times.push_back(ms);
+      out << size << ";";
+      writeTimes(out, times);
+    }
+    out.close();
+    std::cout << "MergeSort " << pattern.label << " done!\n";
+
+    // --- Экспериментальные замеры для MergeInsertionSort ---
+    std::ofstream outMI(std::string("merge_insertion_sort_") + pattern.fileSuffix + ".csv");
+    outMI << "size;threshold;" << kTimesColumns << "\n";
+    for (std::size_t size: sizes) {
+      std::span<const int> view = ArrayGenerator::getSubArray(base, size);
+      for (int threshold: thresholds) {
+        std::vector<long long> times;
+        times.reserve(9);
+        for (int i = 0; i < 9; i++) {
+          MergeInsertionSort sorter(threshold);
+          std::span<int> work_mas = arena.load(view);
+          long long ms = SortTester::measureTimeMISort(work_mas, mergeTemp, sorter);
+          times.push_back(ms);
+        }
+        outMI << size << ";" << threshold << ";";
+        writeTimes(outMI, times);
       }
-      outNearlySortedMI << size << ";" << threshold <<";"<< times[0] << ";" << times[1] << ";" << times[2] << ";" << times[3]
-      << ";" << times[4] << ";" << times[5] << ";" << times[6] << ";" << times[7] << ";" << times[8] << ";";
-      std::sort(times.begin(), times.end());
-      long long med = times[4];
-      outNearlySortedMI  << med << "\n";
     }
+    outMI.close();
+    std::cout << "MergeInsertionSort " << pattern.label << " done!\n";
   }
-  outNearlySortedMI.close();
-  std::cout<<"MergeInsertionSort nearly sorted done!\n";
 
   return 0;
 }
@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <string>
+#include <vector>
+#include "../common/ArrayGenerator.h"
+#include "../common/BenchArgs.h"
+#include "../common/BenchCsv.h"
+#include "../common/IntroSort.h"
+#include "../common/MergeSort.h"
+#include "../common/RecordSort.h"
+
+// Запись из реальной нагрузки: int-ключ и 60 байт полезных данных (одна кэш-линия).
+struct Record {
+  int key;
+  int payload[15];
+
+  friend bool operator<=(const Record &a, const Record &b) {
+    return a.key <= b.key;
+  }
+  friend bool operator>(const Record &a, const Record &b) {
+    return a.key > b.key;
+  }
+};
+
+class SortTester {
+public:
+  template <class Fn>
+  static long long measureTime(Fn &&run) {
+    using clock = std::chrono::steady_clock;
+    auto start = clock::now();
+    run();
+    auto elapsed = clock::now() - start;
+    long long ms = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    return ms;
+  }
+};
+
+// Рабочие буферы выделяются один раз под максимальный размер.
+struct Buffers {
+  std::vector<Record> work;
+  std::vector<Record> temp;
+  std::vector<Record> out;
+  std::vector<int> keys;
+  std::vector<std::uint32_t> perm;
+  PermutationBuffers permBuffers;
+
+  explicit Buffers(std::size_t n) : work(n), temp(n), out(n), keys(n), perm(n), permBuffers(n) {}
+};
+
+// AoS: сортируются сами записи
+long long runAoS(std::span<const Record> src, Buffers &buf, bool stable) {
+  std::copy(src.begin(), src.end(), buf.work.begin());
+  std::span<Record> arr(buf.work.data(), src.size());
+  return SortTester::measureTime([&]() {
+    if (stable) {
+      MergeSort sorter;
+      sorter.sort(arr, std::span<Record>(buf.temp.data(), src.size()));
+    } else {
+      introSort(arr);
+    }
+  });
+}
+
+// ключи выносятся в отдельный массив, сортируется перестановка, записи собираются один раз
+long long runIndirect(std::span<const Record> src, Buffers &buf, bool stable, bool packed) {
+  std::size_t n = src.size();
+  std::span<int> keys(buf.keys.data(), n);
+  std::span<std::uint32_t> perm(buf.perm.data(), n);
+  return SortTester::measureTime([&]() {
+    for (std::size_t i = 0; i < n; i++) {
+      keys[i] = src[i].key;
+    }
+    sortPermutation(keys, perm, stable, packed, buf.permBuffers);
+    gather(src, std::span<const std::uint32_t>(perm), std::span<Record>(buf.out.data(), n));
+  });
+}
+
+// Сверка результата gather с устойчивым AoS-результатом (buf.work после MergeSort), вне замеров.
+// Ключи должны совпадать всегда; для устойчивых путей - и сами записи (payload[0] - исходный индекс).
+void verifyGather(const Buffers &buf, std::size_t n, bool stable, const char *method) {
+  for (std::size_t i = 0; i < n; i++) {
+    if (buf.out[i].key != buf.work[i].key || (stable && buf.out[i].payload[0] != buf.work[i].payload[0])) {
+      std::cerr << "RecordSort: " << method << " differs from AoS MergeSort at " << i << " (size " << n << ")\n";
+      std::abort();
+    }
+  }
+}
+
+// порядок совпадает с индексами times в main
+const char *const kMethods[] = {"aos_introsort", "aos_mergesort", "perm_introsort",
+                                "perm_mergesort", "packed_introsort", "packed_mergesort"};
+
+// argv[1] - максимальный размер массива (по умолчанию 100000), argv[2] - шаг (по умолчанию 100)
+int main(int argc, char **argv) {
+  std::size_t maxSize;
+  std::vector<std::size_t> sizes;
+  if (!parseBenchSizes(argc, argv, maxSize, sizes)) {
+    std::cerr << "usage: " << argv[0] << " " << kBenchUsage << "\n";
+    return 1;
+  }
+  Buffers buf(maxSize);
+
+  for (const ArrayPattern &pattern: kArrayPatterns) {
+    std::vector<int> base = pattern.generate(maxSize);
+    std::vector<Record> records(maxSize);
+    for (std::size_t i = 0; i < maxSize; i++) {
+      records[i].key = base[i];
+      std::fill(std::begin(records[i].payload), std::end(records[i].payload), static_cast<int>(i));
+    }
+
+    std::ofstream out(std::string("record_sort_") + pattern.fileSuffix + ".csv");
+    // по строке на метод, как строки с threshold в A2
+    out << "size;method;" << kTimesColumns << "\n";
+    for (std::size_t size: sizes) {
+      std::span<const Record> src(records.data(), size);
+      std::vector<std::vector<long long>> times(6);
+      for (int i = 0; i < 9; i++) {
+        times[0].push_back(runAoS(src, buf, false));
+        times[1].push_back(runAoS(src, buf, true));
+        // buf.work сейчас содержит результат устойчивой AoS-сортировки; проверяем первый прогон
+        bool check = i == 0;
+        times[2].push_back(runIndirect(src, buf, false, false));
+        if (check) {
+          verifyGather(buf, size, false, "perm_introsort");
+        }
+        times[3].push_back(runIndirect(src, buf, true, false));
+        if (check) {
+          verifyGather(buf, size, true, "perm_mergesort");
+        }
+        times[4].push_back(runIndirect(src, buf, false, true));
+        if (check) {
+          verifyGather(buf, size, true, "packed_introsort");
+        }
+        times[5].push_back(runIndirect(src, buf, true, true));
+        if (check) {
+          verifyGather(buf, size, true, "packed_mergesort");
+        }
+      }
+      for (std::size_t m = 0; m < times.size(); m++) {
+        out << size << ";" << kMethods[m] << ";";
+        writeTimes(out, times[m]);
+      }
+    }
+    out.close();
+    std::cout << "RecordSort " << pattern.label << " done!\n";
+  }
+
+  return 0;
+}
@@ -0,0 +1,242 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <thread>
+#include <vector>
+
+// Общий генератор входных данных для A2 и A3.
+// Каждый элемент считается из (seed, индекс) через splitmix64, поэтому результат
+// не зависит от числа потоков, а внутренние циклы не имеют зависимостей и векторизуются.
+// У каждого случайного распределения свой seed, иначе они были бы поэлементно связаны.
+class ArrayGenerator {
+private:
+  static constexpr std::uint64_t kSeed = 12345;
+  static constexpr std::size_t kGrain = 1 << 16;
+
+  enum Stream : std::uint64_t {
+    kRandomStream = 1,
+    kZipfStream,
+    kFewUniqueStream,
+    kRandomRunsStream,
+  };
+
+  static std::uint64_t mix(std::uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+  }
+
+  // seed потока: перемешанный номер, так что потоки разнесены по всему 64-битному пространству
+  // и не пересекаются на индексах < 2^31 (а не сдвинуты друг относительно друга на единицы)
+  static std::uint64_t streamSeed(Stream stream) {
+    return mix(kSeed ^ (stream * 0xD1B54A32D192ED03ULL));
+  }
+
+  // равномерно в [0, bound)
+  static int uniformAt(std::uint64_t seed, std::size_t i, std::uint32_t bound) {
+    return static_cast<int>(((mix(seed + i) >> 32) * bound) >> 32);
+  }
+
+  // равномерно в [0, 1)
+  static double unitAt(std::uint64_t seed, std::size_t i) {
+    return static_cast<double>(mix(seed + i) >> 11) * 0x1.0p-53;
+  }
+
+  template <class Fn>
+  static void parallelFor(std::size_t n, std::size_t grain, Fn fn) {
+    std::size_t blocks = (n + grain - 1) / grain;
+    std::size_t threads = std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), blocks);
+    if (threads <= 1) {
+      fn(0, n);
+      return;
+    }
+    std::atomic<std::size_t> next{0};
+    auto worker = [&]() {
+      for (std::size_t b = next++; b < blocks; b = next++) {
+        fn(b * grain, std::min(n, (b + 1) * grain));
+      }
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (std::size_t t = 1; t < threads; t++) {
+      pool.emplace_back(worker);
+    }
+    worker();
+    for (std::thread &t: pool) {
+      t.join();
+    }
+  }
+
+public:
+  static std::vector<int> genRandom(std::size_t n) {
+    std::uint64_t seed = streamSeed(kRandomStream);
+    std::vector<int> generated(n);
+    int *out = generated.data();
+    parallelFor(n, kGrain, [out, seed](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; i++) {
+        out[i] = uniformAt(seed, i, 10001);
+      }
+    });
+    return generated;
+  }
+
+  static std::vector<int> genSorted(std::size_t n) {
+    std::vector<int> generated(n);
+    int *out = generated.data();
+    parallelFor(n, kGrain, [out](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; i++) {
+        out[i] = static_cast<int>(i);
+      }
+    });
+    return generated;
+  }
+
+  static std::vector<int> genReverseSorted(std::size_t n) {
+    std::vector<int> generated(n);
+    int *out = generated.data();
+    parallelFor(n, kGrain, [out, n](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; i++) {
+        out[i] = static_cast<int>(n - i - 1);
+      }
+    });
+    return generated;
+  }
+
+  static std::vector<int> genNearlySorted(std::size_t n) {
+    std::vector<int> generated = genSorted(n);
+    if (n < 2) {
+      return generated;
+    }
+    std::mt19937 gen(12345);
+    std::uniform_int_distribution<std::size_t> dist(0, n - 2);
+
+    // перестановки последовательны по смыслу, но их всего n / 25
+    std::size_t swaps = n / 25;
+    for (std::size_t i = 0; i < swaps; i++) {
+      std::size_t pos = dist(gen);
+      std::swap(generated[pos], generated[pos + 1]);
+    }
+    return generated;
+  }
+
+  // "эффективное" число различных значений genZipf: 1 / сумма p_k^2,
+  // т.е. столько равновероятных значений дали бы столько же совпадающих пар
+  static double zipfDistinctValues(int distinct = 10000, double s = 1.0) {
+    double sum = 0.0;
+    double sumSq = 0.0;
+    for (int k = 0; k < distinct; k++) {
+      double w = 1.0 / std::pow(k + 1, s);
+      sum += w;
+      sumSq += w * w;
+    }
+    return sum * sum / sumSq;
+  }
+
+  // значение k (0 <= k < distinct) встречается с вероятностью ~ 1 / (k + 1)^s
+  static std::vector<int> genZipf(std::size_t n, int distinct = 10000, double s = 1.0) {
+    std::vector<double> cdf(distinct);
+    double sum = 0.0;
+    for (int k = 0; k < distinct; k++) {
+      sum += 1.0 / std::pow(k + 1, s);
+      cdf[k] = sum;
+    }
+    for (double &c: cdf) {
+      c /= sum;
+    }
+    std::uint64_t seed = streamSeed(kZipfStream);
+    std::vector<int> generated(n);
+    int *out = generated.data();
+    parallelFor(n, kGrain, [out, seed, &cdf](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; i++) {
+        auto it = std::upper_bound(cdf.begin(), cdf.end() - 1, unitAt(seed, i));
+        out[i] = static_cast<int>(it - cdf.begin());
+      }
+    });
+    return generated;
+  }
+
+  static std::vector<int> genFewUnique(std::size_t n, int unique = 16) {
+    int stride = 10000 / unique;
+    std::uint64_t seed = streamSeed(kFewUniqueStream);
+    std::vector<int> generated(n);
+    int *out = generated.data();
+    parallelFor(n, kGrain, [out, seed, unique, stride](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; i++) {
+        out[i] = uniformAt(seed, i, unique) * stride;
+      }
+    });
+    return generated;
+  }
+
+  // 0, 1, ..., n/2, ..., 1, 0
+  static std::vector<int> genOrganPipe(std::size_t n) {
+    std::vector<int> generated(n);
+    int *out = generated.data();
+    parallelFor(n, kGrain, [out, n](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; i++) {
+        out[i] = static_cast<int>(std::min(i, n - i - 1));
+      }
+    });
+    return generated;
+  }
+
+  static std::vector<int> genSawtooth(std::size_t n, std::size_t period = 1000) {
+    std::vector<int> generated(n);
+    int *out = generated.data();
+    parallelFor(n, kGrain, [out, period](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; i++) {
+        out[i] = static_cast<int>(i % period);
+      }
+    });
+    return generated;
+  }
+
+  // случайный массив, разбитый на отсортированные отрезки длины runLength
+  static std::vector<int> genRandomRuns(std::size_t n, std::size_t runLength = 1000) {
+    std::vector<int> generated(n);
+    int *out = generated.data();
+    std::uint64_t seed = streamSeed(kRandomRunsStream);
+    std::size_t grain = std::max<std::size_t>(1, kGrain / runLength) * runLength;
+    parallelFor(n, grain, [out, seed, runLength](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; i++) {
+        out[i] = uniformAt(seed, i, 10001);
+      }
+      for (std::size_t run = begin; run < end; run += runLength) {
+        std::sort(out + run, out + std::min(end, run + runLength));
+      }
+    });
+    return generated;
+  }
+
+  // префикс базового массива без копирования
+  static std::span<const int> getSubArray(const std::vector<int> &baseArray, std::size_t exactSize) {
+    return std::span<const int>(baseArray.data(), exactSize);
+  }
+};
+
+// Набор входных распределений для замеров: суффикс CSV-файла, подпись в логе, генератор.
+// distinctValues - (эффективное) число различных значений, от которого зависит число повторов
+// каждого ключа при росте n; 0 - ключи почти не повторяются.
+struct ArrayPattern {
+  const char *fileSuffix;
+  const char *label;
+  std::vector<int> (*generate)(std::size_t);
+  double distinctValues;
+};
+
+inline const ArrayPattern kArrayPatterns[] = {
+  {"random", "random", [](std::size_t n) { return ArrayGenerator::genRandom(n); }, 10001},
+  {"reversed", "reverse", [](std::size_t n) { return ArrayGenerator::genReverseSorted(n); }, 0},
+  {"nearly_sorted", "nearly sorted", [](std::size_t n) { return ArrayGenerator::genNearlySorted(n); }, 0},
+  {"zipf", "zipf", [](std::size_t n) { return ArrayGenerator::genZipf(n); }, ArrayGenerator::zipfDistinctValues()},
+  {"few_unique", "few unique", [](std::size_t n) { return ArrayGenerator::genFewUnique(n); }, 16},
+  {"organ_pipe", "organ pipe", [](std::size_t n) { return ArrayGenerator::genOrganPipe(n); }, 0},
+  {"sawtooth", "sawtooth", [](std::size_t n) { return ArrayGenerator::genSawtooth(n); }, 1000},
+  {"random_runs", "random runs", [](std::size_t n) { return ArrayGenerator::genRandomRuns(n); }, 10001},
+};
@@ -0,0 +1,48 @@
+#pragma once
+#include <cerrno>
+#include <cstddef>
+#include <climits>
+#include <cstdlib>
+#include <vector>
+
+// Неотрицательное целое без лишних символов; "-5" strtoull молча превратил бы в огромное число.
+inline bool parseSizeArg(const char *text, std::size_t &value) {
+  if (text[0] < '0' || text[0] > '9') {
+    return false;
+  }
+  char *end = nullptr;
+  errno = 0;
+  unsigned long long parsed = std::strtoull(text, &end, 10);
+  if (*end != '\0' || errno == ERANGE) {
+    return false;
+  }
+  value = static_cast<std::size_t>(parsed);
+  return true;
+}
+
+// Сортировки индексируют массив через int, поэтому размер не может превышать INT_MAX.
+inline constexpr std::size_t kMaxBenchSize = INT_MAX;
+inline constexpr const char *kBenchUsage = "[maxSize <= 2147483647] [step > 0]";
+
+// argv[1] - максимальный размер массива (по умолчанию 100000), argv[2] - шаг (по умолчанию 100).
+// Размеры идут от 500 до maxSize. false - аргументы некорректны (не число, нулевой шаг,
+// maxSize > kMaxBenchSize, лишние аргументы).
+inline bool parseBenchSizes(int argc, char **argv, std::size_t &maxSize, std::vector<std::size_t> &sizes) {
+  maxSize = 100000;
+  std::size_t step = 100;
+  if (argc > 3 || (argc > 1 && !parseSizeArg(argv[1], maxSize)) || (argc > 2 && !parseSizeArg(argv[2], step))) {
+    return false;
+  }
+  if (step == 0 || maxSize > kMaxBenchSize) {
+    return false;
+  }
+  sizes.clear();
+  for (std::size_t i = 500; i <= maxSize; i += step) {
+    sizes.push_back(i);
+    // i + step не должен переполниться при огромном шаге
+    if (step > maxSize - i) {
+      break;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <algorithm>
+#include <ostream>
+#include <vector>
+
+// Столбцы замеров в CSV: 9 прогонов и медиана (время в микросекундах, исторически подписано _ms).
+inline constexpr const char *kTimesColumns =
+  "time_run1_ms;time_run2_ms;time_run3_ms;time_run4_ms;time_run5_ms;time_run6_ms;time_run7_ms;time_run8_ms;"
+  "time_run9_ms;med_ms";
+
+// Дописывает к строке все прогоны и медиану; times сортируется.
+inline void writeTimes(std::ostream &out, std::vector<long long> &times) {
+  for (long long t: times) {
+    out << t << ";";
+  }
+  std::sort(times.begin(), times.end());
+  long long med = times[times.size() / 2];
+  out << med << "\n";
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+// Seq - std::span<T> или любое представление с operator[] и value_type.
+template <class Seq>
+void insertionSort(Seq arr, int low, int high) {
+  for (int i = low + 1; i <= high; i++) {
+    typename Seq::value_type key = arr[i];
+    int j = i - 1;
+    while (j >= low && arr[j] > key) {
+      arr[j + 1] = arr[j];
+      j--;
+    }
+    arr[j + 1] = key;
+  }
+}
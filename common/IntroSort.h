@@ -0,0 +1,101 @@
+#pragma once
+#include <cmath>
+#include <random>
+#include <utility>
+#include "InsertionSort.h"
+
+// swap без квалификации: для std::span подхватывается std::swap, для прокси-ссылок - их swap по ADL
+template <class Seq>
+int partition(Seq arr, int low, int high) {
+  using std::swap;
+  static std::mt19937 gen(19454651);
+  std::uniform_int_distribution<> dist(low, high);
+  int randomIndex = dist(gen);
+  swap(arr[randomIndex], arr[high]);
+
+  typename Seq::value_type pivot = arr[high];
+  int i = low - 1;
+  for (int j = low; j < high; j++) {
+    if (arr[j] <= pivot) {
+      i++;
+      swap(arr[i], arr[j]);
+    }
+  }
+  swap(arr[i + 1], arr[high]);
+  return i + 1;
+}
+
+template <class Seq>
+void quicksortHelper(Seq arr, int low, int high) {
+  if (low < high) {
+    int pi = partition(arr, low, high);
+    quicksortHelper(arr, low, pi - 1);
+    quicksortHelper(arr, pi + 1, high);
+  }
+}
+
+template <class Seq>
+void quickSort(Seq arr) {
+  int n = static_cast<int>(arr.size());
+  if (n <= 1) {
+    return;
+  }
+  quicksortHelper(arr, 0, n - 1);
+}
+
+template <class Seq>
+void heapify(Seq arr, int low, int n, int i) {
+  using std::swap;
+  int largest = i;
+  int left = 2 * i + 1;
+  int right = 2 * i + 2;
+  if (left < n && arr[low + left] > arr[low + largest]) {
+    largest = left;
+  }
+  if (right < n && arr[low + right] > arr[low + largest]) {
+    largest = right;
+  }
+  if (largest != i) {
+    swap(arr[low + i], arr[low + largest]);
+    heapify(arr, low, n, largest);
+  }
+}
+
+template <class Seq>
+void heapSort(Seq arr, int low, int high) {
+  using std::swap;
+  int n = high - low + 1;
+  for (int i = n / 2 - 1; i >= 0; i--) {
+    heapify(arr, low, n, i);
+  }
+  for (int i = n - 1; i > 0; i--) {
+    swap(arr[low], arr[low + i]);
+    heapify(arr, low, i, 0);
+  }
+}
+
+template <class Seq>
+void introSortHelper(Seq arr, int low, int high, int recDepth) {
+  int n = high - low + 1;
+  if (n <= 16) {
+    insertionSort(arr, low, high);
+    return;
+  }
+  if (recDepth == 0) {
+    heapSort(arr, low, high);
+    return;
+  }
+  int pi = partition(arr, low, high);
+  introSortHelper(arr, low, pi - 1, recDepth - 1);
+  introSortHelper(arr, pi, high, recDepth - 1);
+}
+
+template <class Seq>
+void introSort(Seq arr) {
+  int n = static_cast<int>(arr.size());
+  if (n <= 1) {
+    return;
+  }
+  int maxRecDepth = 2 * static_cast<int>(std::log2(n));
+  introSortHelper(arr, 0, n - 1, maxRecDepth);
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "InsertionSort.h"
+
+// temp - внешний буфер не короче right - left + 1: слияние само ничего не выделяет
+template <class Seq>
+void merge(Seq arr, const int left, const int mid, const int right, std::span<typename Seq::value_type> temp) {
+  int i = left;
+  int j = mid + 1;
+  int k = 0;
+  while (i <= mid && j <= right) {
+    if (arr[i] <= arr[j]) {
+      temp[k++] = arr[i++];
+    } else {
+      temp[k++] = arr[j++];
+    }
+  }
+  while (i <= mid) {
+    temp[k++] = arr[i++];
+  }
+  while (j <= right) {
+    temp[k++] = arr[j++];
+  }
+  for (int l = 0; l < k; l++) {
+    arr[left + l] = temp[l];
+  }
+}
+
+// sort/MISort принимают буфер слияния размером не меньше arr.size(); его можно выделить
+// один раз на все прогоны. Без буфера он выделяется на каждый вызов сортировки.
+class MergeSort {
+private:
+  template <class Seq>
+  void mergeSort(Seq arr, int left, int right, std::span<typename Seq::value_type> temp) {
+    if (left >= right) {
+      return;
+    }
+    int mid = left + (right - left) / 2;
+    mergeSort(arr, left, mid, temp);
+    mergeSort(arr, mid + 1, right, temp);
+    merge(arr, left, mid, right, temp);
+  }
+
+public:
+  template <class Seq>
+  void sort(Seq arr, std::span<typename Seq::value_type> temp) {
+    if (temp.size() < arr.size()) {
+      throw std::length_error("MergeSort::sort: temp buffer is shorter than the array");
+    }
+    if (arr.empty()) {
+      return;
+    }
+    mergeSort(arr, 0, static_cast<int>(arr.size()) - 1, temp);
+  }
+  template <class Seq>
+  void sort(Seq arr) {
+    std::vector<typename Seq::value_type> temp(arr.size());
+    sort(arr, std::span<typename Seq::value_type>(temp));
+  }
+};
+
+class MergeInsertionSort {
+private:
+  int threshold;
+  template <class Seq>
+  void mergeInsertionSort(Seq arr, int left, int right, std::span<typename Seq::value_type> temp) {
+    if (right - left + 1 <= threshold) {
+      insertionSort(arr, left, right);
+      return;
+    }
+    int mid = left + (right - left) / 2;
+    mergeInsertionSort(arr, left, mid, temp);
+    mergeInsertionSort(arr, mid + 1, right, temp);
+    merge(arr, left, mid, right, temp);
+  }
+
+public:
+  explicit MergeInsertionSort(int th) : threshold(th) {}
+  template <class Seq>
+  void MISort(Seq arr, std::span<typename Seq::value_type> temp) {
+    if (temp.size() < arr.size()) {
+      throw std::length_error("MergeInsertionSort::MISort: temp buffer is shorter than the array");
+    }
+    if (arr.empty()) {
+      return;
+    }
+    mergeInsertionSort(arr, 0, static_cast<int>(arr.size()) - 1, temp);
+  }
+  template <class Seq>
+  void MISort(Seq arr) {
+    std::vector<typename Seq::value_type> temp(arr.size());
+    MISort(arr, std::span<typename Seq::value_type>(temp));
+  }
+};
@@ -0,0 +1,187 @@
+#pragma once
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "IntroSort.h"
+#include "MergeSort.h"
+
+// Сортировка записей по int-ключу без перемещения самих записей.
+// Оба пути работают поверх introSort (stable = false) и MergeSort (stable = true):
+//  - sortKeyValue: ключи и полезная нагрузка лежат в двух параллельных массивах (SoA)
+//    и переставляются вместе;
+//  - sortPermutation: возвращает перестановку индексов; в упакованном режиме
+//    (ключ, индекс) хранятся в одном 64-битном слове и сортируются как обычные числа.
+// Сами записи переставляются один раз в конце через gather.
+
+template <class P>
+struct KeyValue {
+  int key;
+  P value;
+};
+
+// Прокси-ссылка на i-й элемент KeyValueSpan: присваивание и swap затрагивают оба массива.
+template <class P>
+class KeyValueRef {
+private:
+  int *key_;
+  P *value_;
+
+public:
+  KeyValueRef(int *key, P *value) : key_(key), value_(value) {}
+  KeyValueRef(const KeyValueRef &) = default;
+
+  KeyValueRef &operator=(const KeyValueRef &other) {
+    *key_ = *other.key_;
+    *value_ = *other.value_;
+    return *this;
+  }
+  KeyValueRef &operator=(const KeyValue<P> &kv) {
+    *key_ = kv.key;
+    *value_ = kv.value;
+    return *this;
+  }
+  operator KeyValue<P>() const {
+    return {*key_, *value_};
+  }
+
+  friend void swap(KeyValueRef a, KeyValueRef b) {
+    std::swap(*a.key_, *b.key_);
+    std::swap(*a.value_, *b.value_);
+  }
+
+  friend bool operator<=(const KeyValueRef &a, const KeyValueRef &b) {
+    return *a.key_ <= *b.key_;
+  }
+  friend bool operator<=(const KeyValueRef &a, const KeyValue<P> &b) {
+    return *a.key_ <= b.key;
+  }
+  friend bool operator>(const KeyValueRef &a, const KeyValueRef &b) {
+    return *a.key_ > *b.key_;
+  }
+  friend bool operator>(const KeyValueRef &a, const KeyValue<P> &b) {
+    return *a.key_ > b.key;
+  }
+};
+
+template <class P>
+class KeyValueSpan {
+private:
+  std::span<int> keys_;
+  std::span<P> values_;
+
+public:
+  using value_type = KeyValue<P>;
+
+  KeyValueSpan(std::span<int> keys, std::span<P> values) : keys_(keys), values_(values) {}
+
+  KeyValueRef<P> operator[](std::size_t i) const {
+    return KeyValueRef<P>(&keys_[i], &values_[i]);
+  }
+  std::size_t size() const {
+    return keys_.size();
+  }
+  bool empty() const {
+    return keys_.empty();
+  }
+};
+
+// temp - буфер слияния (нужен только при stable), не короче keys.size()
+template <class P>
+void sortKeyValue(std::span<int> keys, std::span<P> values, bool stable, std::span<KeyValue<P>> temp) {
+  // сортировки индексируют через int
+  if (keys.size() > INT_MAX) {
+    throw std::length_error("sortKeyValue: more than INT_MAX keys");
+  }
+  if (values.size() != keys.size()) {
+    throw std::length_error("sortKeyValue: keys and values differ in size");
+  }
+  KeyValueSpan<P> arr(keys, values);
+  if (stable) {
+    MergeSort sorter;
+    sorter.sort(arr, temp);
+  } else {
+    introSort(arr);
+  }
+}
+
+template <class P>
+void sortKeyValue(std::span<int> keys, std::span<P> values, bool stable) {
+  std::vector<KeyValue<P>> temp(stable ? keys.size() : 0);
+  sortKeyValue(keys, values, stable, std::span<KeyValue<P>>(temp));
+}
+
+// Старшие 32 бита - ключ со сдвигом знака (чтобы беззнаковый порядок совпадал со знаковым),
+// младшие - исходный индекс. Равных слов не бывает, поэтому результат устойчив при любом алгоритме.
+inline std::uint64_t packKeyIndex(int key, std::uint32_t index) {
+  std::uint32_t biased = static_cast<std::uint32_t>(key) ^ 0x80000000u;
+  return (static_cast<std::uint64_t>(biased) << 32) | index;
+}
+
+inline int unpackKey(std::uint64_t word) {
+  return static_cast<int>(static_cast<std::uint32_t>(word >> 32) ^ 0x80000000u);
+}
+
+// Рабочая память sortPermutation: выделяется (и заполняется, т.е. прогревается) один раз
+// под максимальный размер, как WorkArena, чтобы в замеры не попадали выделения и page fault'ы.
+struct PermutationBuffers {
+  std::vector<std::uint64_t> words;
+  std::vector<std::uint64_t> wordsTemp;
+  std::vector<KeyValue<std::uint32_t>> pairsTemp;
+
+  explicit PermutationBuffers(std::size_t n) : words(n), wordsTemp(n), pairsTemp(n) {}
+};
+
+// perm получает порядок индексов, keys сортируется на месте в обоих режимах.
+// perm должен быть длины keys.size(), буферы buf - не короче; иначе std::length_error.
+inline void sortPermutation(std::span<int> keys, std::span<std::uint32_t> perm, bool stable, bool packed,
+                            PermutationBuffers &buf) {
+  std::size_t n = keys.size();
+  // INT_MAX покрывает и int-индексы сортировок, и 32-битный индекс в упакованном слове
+  if (n > INT_MAX) {
+    throw std::length_error("sortPermutation: more than INT_MAX keys");
+  }
+  if (perm.size() != n) {
+    throw std::length_error("sortPermutation: perm and keys differ in size");
+  }
+  // проверяются только буферы, которые нужны выбранному режиму
+  bool wordsShort = packed && (buf.words.size() < n || (stable && buf.wordsTemp.size() < n));
+  bool pairsShort = !packed && stable && buf.pairsTemp.size() < n;
+  if (wordsShort || pairsShort) {
+    throw std::length_error("sortPermutation: PermutationBuffers are smaller than keys");
+  }
+  if (packed) {
+    std::span<std::uint64_t> words(buf.words.data(), n);
+    for (std::size_t i = 0; i < n; i++) {
+      words[i] = packKeyIndex(keys[i], static_cast<std::uint32_t>(i));
+    }
+    if (stable) {
+      MergeSort sorter;
+      sorter.sort(words, std::span<std::uint64_t>(buf.wordsTemp.data(), n));
+    } else {
+      introSort(words);
+    }
+    for (std::size_t i = 0; i < n; i++) {
+      keys[i] = unpackKey(words[i]);
+      perm[i] = static_cast<std::uint32_t>(words[i]);
+    }
+  } else {
+    std::iota(perm.begin(), perm.end(), 0u);
+    sortKeyValue(keys, perm, stable, std::span<KeyValue<std::uint32_t>>(buf.pairsTemp.data(), stable ? n : 0));
+  }
+}
+
+// out[i] = src[perm[i]] - единственное перемещение больших записей
+template <class Record>
+void gather(std::span<const Record> src, std::span<const std::uint32_t> perm, std::span<Record> out) {
+  if (out.size() < perm.size()) {
+    throw std::length_error("gather: out is shorter than perm");
+  }
+  for (std::size_t i = 0; i < perm.size(); i++) {
+    out[i] = src[perm[i]];
+  }
+}